@@ -0,0 +1,419 @@
+// Offline analyser for the laneA-D.txt logs written by generateVehicle().
+//
+// Each log line has the form  V<id>,HH:MM:SS,<road>L<lane>,left|straight
+// The files are memory-mapped, split at line boundaries across worker threads
+// and reduced to per-lane time-bucket aggregates, printed as CSV.
+//
+// Build: gcc -O2 -pthread lane_analyzer.c -o lane_analyzer
+// Usage: ./lane_analyzer [-b bucketSeconds] [-j threads] [-o out.csv] [files...]
+//        (defaults: 300 second buckets, one thread per core, laneA-D.txt)
+//
+// Files belonging to the same road form one continuous timeline, in the order
+// they are given, so rotated logs must be passed oldest first. A file's road
+// is taken from its first entry.
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define NUM_ROADS 4
+#define LANES_PER_ROAD 4
+#define NUM_LANES (NUM_ROADS * LANES_PER_ROAD)
+#define SECONDS_PER_DAY 86400
+#define DEFAULT_BUCKET_SECONDS 300
+#define MAX_THREADS 256
+#define MIN_CHUNK_BYTES (1 << 20)  // Don't bother splitting below 1 MB per thread
+#define INITIAL_DAYS 4
+
+typedef struct {
+    unsigned int arrivals;
+    unsigned int left;
+} BucketCount;
+
+// Position reached so far on one road's timeline, carried from file to file.
+typedef struct {
+    int lastDay;           // Day index of the last entry merged, counted from the road's first entry
+    int lastSecond;        // Time of day of that entry, -1 before the first one
+} RoadTimeline;
+
+// One contiguous slice of a mapped file, always starting at a line start.
+// Days are counted locally from the chunk's first line; mergeChunks() later
+// places them on the road's timeline.
+typedef struct {
+    const char *begin;
+    const char *end;
+    int bucketSeconds;
+    int bucketsPerDay;
+    int firstSecond;       // Time of day of the first valid line, -1 if none
+    int firstRoad;         // Road index of the first valid line
+    int lastSecond;        // Time of day of the last valid line
+    int lastDay;           // Local day index of the last valid line
+    BucketCount *counts;   // [(day * bucketsPerDay + bucket) * NUM_LANES + lane]
+    int capacityDays;
+    long lines;
+    long malformed;
+    bool failed;           // Set if the chunk could not be fully aggregated
+} Chunk;
+
+// Find the next '\n' in [p, end), or return end if there is none.
+static const char *findNewline(const char *p, const char *end) {
+#ifdef __SSE2__
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)p);
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, nl));
+        if (mask)
+            return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    const char *hit = (const char *)memchr(p, '\n', end - p);
+    return hit ? hit : end;
+}
+
+static inline int digit(char c) {
+    return (c >= '0' && c <= '9') ? c - '0' : -1;
+}
+
+// Parse one line (without its '\n'). Returns false if it is not a log entry.
+static bool parseLine(const char *p, const char *end, int *second, int *lane, bool *left) {
+    if (p < end && end[-1] == '\r')
+        end--;
+    if (p >= end || *p != 'V')
+        return false;
+    p++;
+    while (p < end && digit(*p) >= 0)
+        p++;
+    // Remaining fixed layout: ",HH:MM:SS,XLn,"  (14 bytes) + direction
+    if (end - p < 15 || p[0] != ',' || p[3] != ':' || p[6] != ':' || p[9] != ',' ||
+        p[11] != 'L' || p[13] != ',')
+        return false;
+
+    int h1 = digit(p[1]), h2 = digit(p[2]);
+    int m1 = digit(p[4]), m2 = digit(p[5]);
+    int s1 = digit(p[7]), s2 = digit(p[8]);
+    if ((h1 | h2 | m1 | m2 | s1 | s2) < 0)
+        return false;
+    int hours = h1 * 10 + h2, minutes = m1 * 10 + m2, seconds = s1 * 10 + s2;
+    if (hours > 23 || minutes > 59 || seconds > 59)
+        return false;
+
+    int road = p[10] - 'A';
+    int laneNumber = digit(p[12]);
+    if (road < 0 || road >= NUM_ROADS || laneNumber < 1 || laneNumber > LANES_PER_ROAD)
+        return false;
+
+    const char *dir = p + 14;
+    size_t dirLen = end - dir;
+    if (dirLen == 4 && memcmp(dir, "left", 4) == 0)
+        *left = true;
+    else if (dirLen == 8 && memcmp(dir, "straight", 8) == 0)
+        *left = false;
+    else
+        return false;
+
+    *second = hours * 3600 + minutes * 60 + seconds;
+    *lane = road * LANES_PER_ROAD + (laneNumber - 1);
+    return true;
+}
+
+static bool growChunk(Chunk *c, int day) {
+    int newCapacity = c->capacityDays ? c->capacityDays : INITIAL_DAYS;
+    while (newCapacity <= day)
+        newCapacity *= 2;
+    size_t perDay = (size_t)c->bucketsPerDay * NUM_LANES;
+    BucketCount *counts = (BucketCount *)realloc(c->counts, sizeof(BucketCount) * perDay * newCapacity);
+    if (!counts)
+        return false;
+    memset(counts + perDay * c->capacityDays, 0,
+           sizeof(BucketCount) * perDay * (newCapacity - c->capacityDays));
+    c->counts = counts;
+    c->capacityDays = newCapacity;
+    return true;
+}
+
+static void *processChunk(void *arg) {
+    Chunk *c = (Chunk *)arg;
+    const char *p = c->begin;
+    int day = 0;
+    int prevSecond = -1;
+
+    while (p < c->end) {
+        const char *eol = findNewline(p, c->end);
+        int second, lane;
+        bool left;
+        c->lines++;
+        if (!parseLine(p, eol, &second, &lane, &left)) {
+            if (eol > p)
+                c->malformed++;
+            else
+                c->lines--;  // Blank line
+            p = eol + 1;
+            continue;
+        }
+        p = eol + 1;
+
+        // The log only stores the time of day, and entries are appended in
+        // order, so a timestamp going backwards means we passed midnight.
+        if (prevSecond < 0) {
+            c->firstSecond = second;
+            c->firstRoad = lane / LANES_PER_ROAD;
+        } else if (second < prevSecond)
+            day++;
+        prevSecond = second;
+
+        if (day >= c->capacityDays && !growChunk(c, day)) {
+            fprintf(stderr, "Out of memory while aggregating\n");
+            c->failed = true;
+            break;
+        }
+        size_t index = ((size_t)day * c->bucketsPerDay + second / c->bucketSeconds) * NUM_LANES + lane;
+        c->counts[index].arrivals++;
+        if (left)
+            c->counts[index].left++;
+    }
+
+    c->lastSecond = prevSecond;
+    c->lastDay = day;
+    return NULL;
+}
+
+// Add every chunk's counts into the global table, shifting each chunk by the
+// number of midnights that passed before it on the road's timeline (including
+// one that may fall exactly on a chunk or file boundary).
+static bool mergeChunks(Chunk chunks[], int count, RoadTimeline *timeline,
+                        BucketCount **total, int *totalDays, int bucketsPerDay) {
+    size_t perDay = (size_t)bucketsPerDay * NUM_LANES;
+    int baseDay = timeline->lastDay;
+    int prevLastDay = 0;
+    int prevLastSecond = timeline->lastSecond;
+
+    for (int i = 0; i < count; i++) {
+        Chunk *c = &chunks[i];
+        if (c->firstSecond < 0)
+            continue;
+        if (prevLastSecond >= 0)
+            baseDay += prevLastDay + (c->firstSecond < prevLastSecond ? 1 : 0);
+        prevLastDay = c->lastDay;
+        prevLastSecond = c->lastSecond;
+
+        int neededDays = baseDay + c->lastDay + 1;
+        if (neededDays > *totalDays) {
+            BucketCount *grown = (BucketCount *)realloc(*total, sizeof(BucketCount) * perDay * neededDays);
+            if (!grown)
+                return false;
+            memset(grown + perDay * *totalDays, 0, sizeof(BucketCount) * perDay * (neededDays - *totalDays));
+            *total = grown;
+            *totalDays = neededDays;
+        }
+
+        BucketCount *dst = *total + perDay * baseDay;
+        size_t n = perDay * (c->lastDay + 1);
+        for (size_t k = 0; k < n; k++) {
+            dst[k].arrivals += c->counts[k].arrivals;
+            dst[k].left += c->counts[k].left;
+        }
+    }
+    timeline->lastDay = baseDay + prevLastDay;
+    timeline->lastSecond = prevLastSecond;
+    return true;
+}
+
+static bool analyseFile(const char *path, int threads, int bucketSeconds, RoadTimeline timelines[],
+                        BucketCount **total, int *totalDays, long *lines, long *malformed) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        fprintf(stderr, "Failed to stat %s\n", path);
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+    const char *data = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Failed to map %s\n", path);
+        return false;
+    }
+    madvise((void *)data, size, MADV_SEQUENTIAL);
+
+    size_t maxChunks = size / MIN_CHUNK_BYTES + 1;
+    int chunkCount = (size_t)threads < maxChunks ? threads : (int)maxChunks;
+    int bucketsPerDay = (SECONDS_PER_DAY + bucketSeconds - 1) / bucketSeconds;
+
+    Chunk *chunks = (Chunk *)calloc(chunkCount, sizeof(Chunk));
+    pthread_t *workers = (pthread_t *)malloc(sizeof(pthread_t) * chunkCount);
+    if (!chunks || !workers) {
+        fprintf(stderr, "Out of memory\n");
+        free(chunks);
+        free(workers);
+        munmap((void *)data, size);
+        return false;
+    }
+
+    // Cut at roughly equal offsets, then move each cut past the next newline.
+    const char *end = data + size;
+    const char *start = data;
+    for (int i = 0; i < chunkCount; i++) {
+        const char *cut = (i == chunkCount - 1) ? end : data + size / chunkCount * (i + 1);
+        if (cut < start)
+            cut = start;
+        if (cut < end) {
+            cut = findNewline(cut, end);
+            if (cut < end)
+                cut++;
+        }
+        chunks[i].begin = start;
+        chunks[i].end = cut;
+        chunks[i].bucketSeconds = bucketSeconds;
+        chunks[i].bucketsPerDay = bucketsPerDay;
+        chunks[i].firstSecond = -1;
+        start = cut;
+    }
+
+    int started = 0;
+    for (int i = 1; i < chunkCount; i++) {
+        if (pthread_create(&workers[i], NULL, processChunk, &chunks[i]) != 0)
+            break;
+        started = i;
+    }
+    processChunk(&chunks[0]);
+    for (int i = 1; i <= started; i++)
+        pthread_join(workers[i], NULL);
+    // Anything we could not hand to a thread is processed here instead
+    for (int i = started + 1; i < chunkCount; i++)
+        processChunk(&chunks[i]);
+
+    bool ok = true;
+    int road = -1;
+    for (int i = 0; i < chunkCount; i++) {
+        if (chunks[i].failed)
+            ok = false;
+        if (road < 0 && chunks[i].firstSecond >= 0)
+            road = chunks[i].firstRoad;
+    }
+    if (!ok) {
+        fprintf(stderr, "Failed to aggregate %s\n", path);
+    } else if (road >= 0) {
+        ok = mergeChunks(chunks, chunkCount, &timelines[road], total, totalDays, bucketsPerDay);
+        if (!ok)
+            fprintf(stderr, "Out of memory while merging %s\n", path);
+    }
+    for (int i = 0; i < chunkCount; i++) {
+        *lines += chunks[i].lines;
+        *malformed += chunks[i].malformed;
+        free(chunks[i].counts);
+    }
+    free(chunks);
+    free(workers);
+    munmap((void *)data, size);
+    return ok;
+}
+
+static void writeCsv(FILE *out, const BucketCount *total, int totalDays, int bucketSeconds) {
+    int bucketsPerDay = (SECONDS_PER_DAY + bucketSeconds - 1) / bucketSeconds;
+    fprintf(out, "day,bucket_start,lane,arrivals,left,straight,left_share\n");
+    for (int day = 0; day < totalDays; day++) {
+        for (int bucket = 0; bucket < bucketsPerDay; bucket++) {
+            const BucketCount *row = total + ((size_t)day * bucketsPerDay + bucket) * NUM_LANES;
+            int start = bucket * bucketSeconds;
+            for (int lane = 0; lane < NUM_LANES; lane++) {
+                if (row[lane].arrivals == 0)
+                    continue;
+                fprintf(out, "%d,%02d:%02d:%02d,%cL%d,%u,%u,%u,%.4f\n",
+                        day, start / 3600, (start / 60) % 60, start % 60,
+                        'A' + lane / LANES_PER_ROAD, lane % LANES_PER_ROAD + 1,
+                        row[lane].arrivals, row[lane].left,
+                        row[lane].arrivals - row[lane].left,
+                        (double)row[lane].left / row[lane].arrivals);
+            }
+        }
+    }
+}
+
+static void printUsage(const char *program) {
+    printf("Usage: %s [-b bucketSeconds] [-j threads] [-o out.csv] [files...]\n", program);
+    printf("  -b  bucket width in seconds (default %d, e.g. 3600 for hourly)\n", DEFAULT_BUCKET_SECONDS);
+    printf("  -j  worker threads (default: number of online cores)\n");
+    printf("  -o  write CSV to a file instead of stdout\n");
+    printf("  Files are grouped by road (taken from their first entry); files of the same\n");
+    printf("  road must be given oldest first. Day numbers count midnights since the\n");
+    printf("  road's first entry.\n");
+}
+
+int main(int argc, char *argv[]) {
+    int bucketSeconds = DEFAULT_BUCKET_SECONDS;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cores > 0 ? (int)cores : 1;
+    const char *outPath = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:j:o:h")) != -1) {
+        switch (opt) {
+            case 'b': bucketSeconds = atoi(optarg); break;
+            case 'j': threads = atoi(optarg); break;
+            case 'o': outPath = optarg; break;
+            default:
+                printUsage(argv[0]);
+                return opt == 'h' ? 0 : -1;
+        }
+    }
+    if (bucketSeconds <= 0 || bucketSeconds > SECONDS_PER_DAY) {
+        fprintf(stderr, "Bucket width must be between 1 and %d seconds\n", SECONDS_PER_DAY);
+        return -1;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > MAX_THREADS)
+        threads = MAX_THREADS;
+
+    const char *defaultFiles[] = {"laneA.txt", "laneB.txt", "laneC.txt", "laneD.txt"};
+    const char **files = optind < argc ? (const char **)&argv[optind] : defaultFiles;
+    int fileCount = optind < argc ? argc - optind : 4;
+
+    BucketCount *total = NULL;
+    int totalDays = 0;
+    long lines = 0, malformed = 0;
+    RoadTimeline timelines[NUM_ROADS];
+    for (int road = 0; road < NUM_ROADS; road++)
+        timelines[road] = (RoadTimeline){0, -1};
+    for (int i = 0; i < fileCount; i++) {
+        if (!analyseFile(files[i], threads, bucketSeconds, timelines, &total, &totalDays, &lines, &malformed)) {
+            free(total);
+            return -1;
+        }
+    }
+
+    FILE *out = stdout;
+    if (outPath) {
+        out = fopen(outPath, "w");
+        if (!out) {
+            fprintf(stderr, "Failed to open %s for writing\n", outPath);
+            free(total);
+            return -1;
+        }
+    }
+    writeCsv(out, total, totalDays, bucketSeconds);
+    if (out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "Processed %ld lines (%ld malformed) from %d file(s)\n", lines, malformed, fileCount);
+    free(total);
+    return 0;
+}
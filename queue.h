@@ -2,6 +2,7 @@
 #define QUEUE_H
 
 #include <stdbool.h>
+#include <time.h>
 #include <SDL2/SDL.h>
 
 #define DESIRED_FPS 60
@@ -15,7 +16,8 @@
 #define LIGHT_DURATION 5000
 #define ZEBRA_CROSSING_WIDTH 20
 #define ZEBRA_CROSSING_GAP 10
-#define VEHICLE_SPEED 2.0f
+#define VEHICLE_SPEED 2.0f          // Pixels per simulation step
+#define SIMULATION_STEP_MS (1000 / DESIRED_FPS)  // Simulated time advanced per step
 #define ROAD_WIDTH 400
 #define ROAD_HEIGHT 400            // Added definition for ROAD_HEIGHT
 #define ROAD_X_START ((SCREEN_WIDTH - ROAD_WIDTH) / 2)
@@ -24,11 +26,25 @@
 #define QUEUE_NORMAL_THRESHOLD 5       // Renamed to avoid conflict with local variables
 #define CLEARING_TIME 2000
 #define MIN_VEHICLE_SPACING 100
+#define CAMERA_MIN_ZOOM 0.1f
+#define CAMERA_MAX_ZOOM 4.0f
+#define CAMERA_ZOOM_STEP 1.1f      // Zoom factor per mouse-wheel notch
+#define CAMERA_PAN_STEP 50.0f      // Screen pixels per arrow-key press
+#define LOD_ZOOM_THRESHOLD 0.5f    // Below this zoom, lanes are drawn as density heatmaps
+#define GRID_CELL_SIZE 200         // Spatial grid cell size used for visibility culling
+#define GRID_COLS ((SCREEN_WIDTH + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+#define GRID_ROWS ((SCREEN_HEIGHT + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
 
 typedef struct {
     float x, y;
 } TrafficLight;
 
+// World-space view: (x, y) is the world point shown at the window's top-left
+typedef struct {
+    float x, y;
+    float zoom;
+} Camera;
+
 typedef struct Vehicle {
     int id;
     char road;
@@ -38,7 +54,7 @@ typedef struct Vehicle {
     int direction;
     SDL_Rect rect;
     bool isPriority;
-    Uint32 arrivalTime;    // Record the time the vehicle is generated
+    Uint64 arrivalTime;    // Record the time the vehicle is generated
     bool turningLeft;      // Indicates if the vehicle intends to take a left turn
 } Vehicle;
 
@@ -61,8 +77,11 @@ extern SDL_Texture *carTexture;
 extern TrafficLight trafficLights[8];
 extern Uint32 lastBlink;
 extern bool isLightRed;
-extern Uint32 lastSpawnTime;
+extern Uint64 lastSpawnTime;
 extern Uint32 clearingStartTime;
+extern Uint64 simulationTime;     // Simulated milliseconds since start
+extern time_t simulationEpoch;    // Wall-clock time at which the simulation started
+extern bool logEvents;            // Print per-event console messages
 
 // Function prototypes
 void initPriorityQueue(PriorityQueue *pq, int maxSize);
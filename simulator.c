@@ -10,6 +10,9 @@
 
 #define FRAME_DELAY (1000 / DESIRED_FPS)
 #define TIME_PER_VEHICLE 1000  // milliseconds allocated per vehicle to pass
+#define STEP_BUDGET_MS (FRAME_DELAY * 3 / 4)  // real time per frame spent on simulation steps
+#define MAX_FRAME_SKIP_MS (FRAME_DELAY * 3)   // always present a frame at least this often
+#define MAX_LAG_MS 250  // most real time the simulation may fall behind before it is dropped
 
 // Global simulation variables
 Vehicle vehicles[MAX_VEHICLES];
@@ -17,22 +20,54 @@ int lastVehicleId = 0;
 SDL_Texture *carTexture = NULL;
 TrafficLight trafficLights[8];
 Uint32 lastBlink = 0;
-Uint32 lastSpawnTime = 0;
+Uint64 lastSpawnTime = 0;
 Uint32 clearingStartTime = 0;
 
 // New globals for managing the intersection light state:
 char currentGreenRoad = 'A';
-Uint32 currentGreenStartTime = 0;
+Uint64 currentGreenStartTime = 0;
 Uint32 currentGreenDuration = 4000; // Default duration (ms)
 int currentRoadIndex = 0;
 char roads[4] = {'A', 'B', 'C', 'D'};
 
+// Simulated clock. All simulation timing uses simulationTime, which only
+// advances in fixed SIMULATION_STEP_MS steps; the time scale controls how
+// many steps run per unit of real time. Index 0 is paused.
+Uint64 simulationTime = 0;
+time_t simulationEpoch = 0;
+const float timeScales[] = {0.0f, 1.0f, 10.0f, 100.0f, 1000.0f};
+int timeScaleIndex = 1;
+int pausedTimeScaleIndex = 1;
+// Per-event console messages are only printed at real-time speed or slower;
+// above that they would eat the per-frame step budget.
+bool logEvents = true;
+
+// Camera and spatial lookup used by the renderers.
+// gridVehicles holds vehicle indices bucketed by cell; cell c owns the range
+// [gridCellStart[c], gridCellStart[c + 1]).
+Camera camera = {0.0f, 0.0f, 1.0f};
+int gridCellStart[GRID_COLS * GRID_ROWS + 1];
+int gridVehicles[MAX_VEHICLES];
+
 // Function prototypes
 void renderZebraCrossing(SDL_Renderer *renderer);
 void renderLane(SDL_Renderer *renderer);
 void renderTrafficLights(SDL_Renderer *renderer);
 void renderVehicles(SDL_Renderer *renderer);
+void renderLaneDensity(SDL_Renderer *renderer);
 bool isNearLight(Vehicle *v);
+bool rectVisible(SDL_Rect world);
+SDL_Rect worldToScreen(SDL_Rect world);
+void fillWorldRect(SDL_Renderer *renderer, SDL_Rect world);
+void drawWorldRect(SDL_Renderer *renderer, SDL_Rect world);
+void zoomCamera(float factor, int screenX, int screenY);
+void panCamera(float dx, float dy);
+void handleCameraEvent(SDL_Event *e);
+int gridClamp(int value, int count);
+void buildVehicleGrid(void);
+void stepSimulation(PriorityQueue *pq);
+void renderScene(SDL_Renderer *renderer);
+bool handleTimeScaleEvent(SDL_Event *e);
 
 // Update isLightRedForVehicle so that vehicles on the current green road have a green light.
 bool isLightRedForVehicle(Vehicle *v) {
@@ -52,20 +87,154 @@ bool isLightRedForVehicle(Vehicle *v) {
     return approachingIntersection;
 }
 
+// Check whether any part of a world-space rectangle is on screen.
+bool rectVisible(SDL_Rect world) {
+    float x0 = (world.x - camera.x) * camera.zoom;
+    float y0 = (world.y - camera.y) * camera.zoom;
+    float x1 = (world.x + world.w - camera.x) * camera.zoom;
+    float y1 = (world.y + world.h - camera.y) * camera.zoom;
+    return !(x1 < 0 || y1 < 0 || x0 > SCREEN_WIDTH || y0 > SCREEN_HEIGHT);
+}
+
+// Convert a world-space rectangle to screen space using the camera.
+SDL_Rect worldToScreen(SDL_Rect world) {
+    float x0 = (world.x - camera.x) * camera.zoom;
+    float y0 = (world.y - camera.y) * camera.zoom;
+    float x1 = (world.x + world.w - camera.x) * camera.zoom;
+    float y1 = (world.y + world.h - camera.y) * camera.zoom;
+    SDL_Rect screen;
+    screen.x = (int)floorf(x0);
+    screen.y = (int)floorf(y0);
+    screen.w = (int)ceilf(x1) - screen.x;
+    screen.h = (int)ceilf(y1) - screen.y;
+    if (screen.w < 1)
+        screen.w = 1;
+    if (screen.h < 1)
+        screen.h = 1;
+    return screen;
+}
+
+void fillWorldRect(SDL_Renderer *renderer, SDL_Rect world) {
+    if (!rectVisible(world))
+        return;
+    SDL_Rect screen = worldToScreen(world);
+    SDL_RenderFillRect(renderer, &screen);
+}
+
+void drawWorldRect(SDL_Renderer *renderer, SDL_Rect world) {
+    if (!rectVisible(world))
+        return;
+    SDL_Rect screen = worldToScreen(world);
+    SDL_RenderDrawRect(renderer, &screen);
+}
+
+// Zoom by factor while keeping the world point under (screenX, screenY) fixed.
+void zoomCamera(float factor, int screenX, int screenY) {
+    float worldX = camera.x + screenX / camera.zoom;
+    float worldY = camera.y + screenY / camera.zoom;
+    camera.zoom *= factor;
+    if (camera.zoom < CAMERA_MIN_ZOOM)
+        camera.zoom = CAMERA_MIN_ZOOM;
+    if (camera.zoom > CAMERA_MAX_ZOOM)
+        camera.zoom = CAMERA_MAX_ZOOM;
+    camera.x = worldX - screenX / camera.zoom;
+    camera.y = worldY - screenY / camera.zoom;
+}
+
+// Pan by a distance given in screen pixels.
+void panCamera(float dx, float dy) {
+    camera.x += dx / camera.zoom;
+    camera.y += dy / camera.zoom;
+}
+
+// Mouse wheel zooms at the cursor, left-drag or arrow keys pan,
+// +/- zoom around the window centre and Home resets the view.
+void handleCameraEvent(SDL_Event *e) {
+    int mouseX, mouseY;
+    switch (e->type) {
+        case SDL_MOUSEWHEEL:
+            SDL_GetMouseState(&mouseX, &mouseY);
+            if (e->wheel.y > 0)
+                zoomCamera(CAMERA_ZOOM_STEP, mouseX, mouseY);
+            else if (e->wheel.y < 0)
+                zoomCamera(1.0f / CAMERA_ZOOM_STEP, mouseX, mouseY);
+            break;
+        case SDL_MOUSEMOTION:
+            if (e->motion.state & SDL_BUTTON_LMASK)
+                panCamera((float)-e->motion.xrel, (float)-e->motion.yrel);
+            break;
+        case SDL_KEYDOWN:
+            switch (e->key.keysym.sym) {
+                case SDLK_LEFT:  panCamera(-CAMERA_PAN_STEP, 0); break;
+                case SDLK_RIGHT: panCamera(CAMERA_PAN_STEP, 0);  break;
+                case SDLK_UP:    panCamera(0, -CAMERA_PAN_STEP); break;
+                case SDLK_DOWN:  panCamera(0, CAMERA_PAN_STEP);  break;
+                case SDLK_EQUALS:
+                case SDLK_KP_PLUS:
+                    zoomCamera(CAMERA_ZOOM_STEP, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+                    break;
+                case SDLK_MINUS:
+                case SDLK_KP_MINUS:
+                    zoomCamera(1.0f / CAMERA_ZOOM_STEP, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+                    break;
+                case SDLK_HOME:
+                    camera = (Camera){0.0f, 0.0f, 1.0f};
+                    break;
+            }
+            break;
+    }
+}
+
+int gridClamp(int value, int count) {
+    if (value < 0)
+        return 0;
+    if (value >= count)
+        return count - 1;
+    return value;
+}
+
+// Bucket live vehicles by the grid cell containing their centre (counting sort).
+void buildVehicleGrid(void) {
+    int cellOf[MAX_VEHICLES];
+    int next[GRID_COLS * GRID_ROWS];
+    for (int c = 0; c <= GRID_COLS * GRID_ROWS; c++)
+        gridCellStart[c] = 0;
+
+    for (int i = 0; i < MAX_VEHICLES; i++) {
+        Vehicle *v = &vehicles[i];
+        if (v->id < 0) {
+            cellOf[i] = -1;
+            continue;
+        }
+        int col = gridClamp((int)floorf((v->x + v->rect.w / 2) / GRID_CELL_SIZE), GRID_COLS);
+        int row = gridClamp((int)floorf((v->y + v->rect.h / 2) / GRID_CELL_SIZE), GRID_ROWS);
+        cellOf[i] = row * GRID_COLS + col;
+        gridCellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < GRID_COLS * GRID_ROWS; c++) {
+        gridCellStart[c + 1] += gridCellStart[c];
+        next[c] = gridCellStart[c];
+    }
+    for (int i = 0; i < MAX_VEHICLES; i++) {
+        if (cellOf[i] >= 0)
+            gridVehicles[next[cellOf[i]]++] = i;
+    }
+}
+
 void renderZebraCrossing(SDL_Renderer *renderer) {
     for (int i = 0; i < ROAD_WIDTH; i += (ZEBRA_CROSSING_WIDTH + ZEBRA_CROSSING_GAP)) {
         // Top and bottom stripes
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_Rect topStripe = {ROAD_X_START + i, ROAD_Y_START - ZEBRA_CROSSING_WIDTH, ZEBRA_CROSSING_WIDTH, ZEBRA_CROSSING_WIDTH};
-        SDL_RenderFillRect(renderer, &topStripe);
+        fillWorldRect(renderer, topStripe);
         SDL_Rect bottomStripe = {ROAD_X_START + i, ROAD_Y_START + ROAD_WIDTH, ZEBRA_CROSSING_WIDTH, ZEBRA_CROSSING_WIDTH};
-        SDL_RenderFillRect(renderer, &bottomStripe);
+        fillWorldRect(renderer, bottomStripe);
         
         // Left and right stripes
         SDL_Rect leftStripe = {ROAD_X_START - ZEBRA_CROSSING_WIDTH, ROAD_Y_START + i, ZEBRA_CROSSING_WIDTH, ZEBRA_CROSSING_WIDTH};
-        SDL_RenderFillRect(renderer, &leftStripe);
+        fillWorldRect(renderer, leftStripe);
         SDL_Rect rightStripe = {ROAD_X_START + ROAD_WIDTH, ROAD_Y_START + i, ZEBRA_CROSSING_WIDTH, ZEBRA_CROSSING_WIDTH};
-        SDL_RenderFillRect(renderer, &rightStripe);
+        fillWorldRect(renderer, rightStripe);
     }
 }
 
@@ -74,15 +243,15 @@ void renderLane(SDL_Renderer *renderer) {
     SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
     SDL_Rect horizontalRoad = {ROAD_X_START, 0, ROAD_WIDTH, SCREEN_HEIGHT};
     SDL_Rect verticalRoad = {0, ROAD_Y_START, SCREEN_WIDTH, ROAD_WIDTH};
-    SDL_RenderFillRect(renderer, &horizontalRoad);
-    SDL_RenderFillRect(renderer, &verticalRoad);
+    fillWorldRect(renderer, horizontalRoad);
+    fillWorldRect(renderer, verticalRoad);
     
     // Render borders
     SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
     SDL_Rect horizontalBorder = {ROAD_X_START - 2, -2, ROAD_WIDTH + 4, SCREEN_HEIGHT + 4};
     SDL_Rect verticalBorder = {-2, ROAD_Y_START - 2, SCREEN_WIDTH + 4, ROAD_WIDTH + 4};
-    SDL_RenderDrawRect(renderer, &horizontalBorder);
-    SDL_RenderDrawRect(renderer, &verticalBorder);
+    drawWorldRect(renderer, horizontalBorder);
+    drawWorldRect(renderer, verticalBorder);
     
     // Render lane markings (using dashed lines)
     SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
@@ -93,13 +262,13 @@ void renderLane(SDL_Renderer *renderer) {
         for (int y = 0; y < SCREEN_HEIGHT; y += dash + gap) {
             if (y + dash < ROAD_Y_START || y > ROAD_Y_START + ROAD_WIDTH) {
                 SDL_Rect dashLine = {xLane - 3, y, 6, dash};
-                SDL_RenderFillRect(renderer, &dashLine);
+                fillWorldRect(renderer, dashLine);
             }
         }
         for (int x = 0; x < SCREEN_WIDTH; x += dash + gap) {
             if (x + dash < ROAD_X_START || x > ROAD_X_START + ROAD_WIDTH) {
                 SDL_Rect dashLine = {x, yLane - 3, dash, 6};
-                SDL_RenderFillRect(renderer, &dashLine);
+                fillWorldRect(renderer, dashLine);
             }
         }
     }
@@ -131,31 +300,128 @@ void renderTrafficLights(SDL_Renderer *renderer) {
         int x = (int)trafficLights[i].x;
         int y = (int)trafficLights[i].y;
         SDL_Rect lightRect = {x - LIGHT_SIZE/2, y - LIGHT_SIZE/2, LIGHT_SIZE, LIGHT_SIZE};
-        SDL_RenderFillRect(renderer, &lightRect);
+        fillWorldRect(renderer, lightRect);
         
         // Draw border
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_Rect border = {x - LIGHT_SIZE/2 - 2, y - LIGHT_SIZE/2 - 2, LIGHT_SIZE + 4, LIGHT_SIZE + 4};
-        SDL_RenderDrawRect(renderer, &border);
+        drawWorldRect(renderer, border);
     }
 }
 
+// Draw only vehicles whose grid cells overlap the visible part of the world.
+// Cells hold vehicles by centre, so the query is padded by one vehicle length.
 void renderVehicles(SDL_Renderer *renderer) {
+    float viewLeft = camera.x - VEHICLE_HEIGHT;
+    float viewTop = camera.y - VEHICLE_HEIGHT;
+    float viewRight = camera.x + SCREEN_WIDTH / camera.zoom + VEHICLE_HEIGHT;
+    float viewBottom = camera.y + SCREEN_HEIGHT / camera.zoom + VEHICLE_HEIGHT;
+    if (viewRight < 0 || viewBottom < 0 || viewLeft > SCREEN_WIDTH || viewTop > SCREEN_HEIGHT)
+        return;
+    int colStart = gridClamp((int)floorf(viewLeft / GRID_CELL_SIZE), GRID_COLS);
+    int colEnd = gridClamp((int)floorf(viewRight / GRID_CELL_SIZE), GRID_COLS);
+    int rowStart = gridClamp((int)floorf(viewTop / GRID_CELL_SIZE), GRID_ROWS);
+    int rowEnd = gridClamp((int)floorf(viewBottom / GRID_CELL_SIZE), GRID_ROWS);
+
+    for (int row = rowStart; row <= rowEnd; row++) {
+        for (int col = colStart; col <= colEnd; col++) {
+            int cell = row * GRID_COLS + col;
+            for (int k = gridCellStart[cell]; k < gridCellStart[cell + 1]; k++) {
+                Vehicle *v = &vehicles[gridVehicles[k]];
+                // Horizontal cars are drawn rotated by 90 degrees, so cull
+                // against their on-screen footprint rather than v->rect.
+                SDL_Rect bounds = v->rect;
+                if (v->direction == 1 || v->direction == 3) {
+                    bounds.x += (v->rect.w - v->rect.h) / 2;
+                    bounds.y += (v->rect.h - v->rect.w) / 2;
+                    bounds.w = v->rect.h;
+                    bounds.h = v->rect.w;
+                }
+                if (!rectVisible(bounds))
+                    continue;
+                SDL_Rect screen = worldToScreen(v->rect);
+
+                double angle = 0.0;
+                switch (v->direction) {
+                    case 0: angle = 180.0; break; // Down
+                    case 1: angle = 90.0;  break; // Right
+                    case 2: angle = 0.0;   break; // Up
+                    case 3: angle = 270.0; break; // Left
+                }
+
+                if (SDL_RenderCopyEx(renderer, carTexture, NULL, &screen, angle, NULL, SDL_FLIP_NONE) < 0) {
+                    printf("SDL_RenderCopyEx failed: %s\n", SDL_GetError());
+                }
+            }
+        }
+    }
+}
+
+// Zoomed-out level of detail: instead of individual cars, colour each approach
+// lane by how full it is (green = empty, red = full) and overlay a white bar
+// whose length matches the lane's queue of stopped vehicles.
+void renderLaneDensity(SDL_Renderer *renderer) {
+    int approaching[4][4] = {{0}};
+    int waiting[4][4] = {{0}};
     for (int i = 0; i < MAX_VEHICLES; i++) {
         Vehicle *v = &vehicles[i];
-        if (v->id < 0)
+        if (v->id < 0 || v->road < 'A' || v->road > 'D' || v->lane < 1 || v->lane > 4)
             continue;
-        
-        double angle = 0.0;
+        bool onApproach = false;
         switch (v->direction) {
-            case 0: angle = 180.0; break; // Down
-            case 1: angle = 90.0;  break; // Right
-            case 2: angle = 0.0;   break; // Up
-            case 3: angle = 270.0; break; // Left
+            case 0: onApproach = (v->y < ROAD_Y_START); break;
+            case 1: onApproach = (v->x < ROAD_X_START); break;
+            case 2: onApproach = (v->y > ROAD_Y_START + ROAD_HEIGHT); break;
+            case 3: onApproach = (v->x > ROAD_X_START + ROAD_WIDTH); break;
         }
-        
-        if (SDL_RenderCopyEx(renderer, carTexture, NULL, &v->rect, angle, NULL, SDL_FLIP_NONE) < 0) {
-            printf("SDL_RenderCopyEx failed: %s\n", SDL_GetError());
+        if (!onApproach)
+            continue;
+        approaching[v->road - 'A'][v->lane - 1]++;
+        if (v->speed == 0)
+            waiting[v->road - 'A'][v->lane - 1]++;
+    }
+
+    int laneWidth = ROAD_WIDTH / 4;
+    int barWidth = laneWidth / 3;
+    for (int road = 0; road < 4; road++) {
+        // Approach length from the screen edge to the stop line
+        int length = (road == 0 || road == 2) ? ROAD_X_START : ROAD_Y_START;
+        float capacity = (float)length / MIN_VEHICLE_SPACING;
+        for (int lane = 0; lane < 4; lane++) {
+            float density = approaching[road][lane] / capacity;
+            if (density > 1.0f)
+                density = 1.0f;
+            int queueLength = waiting[road][lane] * MIN_VEHICLE_SPACING;
+            if (queueLength > length)
+                queueLength = length;
+
+            int offset = lane * laneWidth;
+            SDL_Rect band, bar;
+            switch (road) {
+                case 0: // A: left approach, heading right
+                    band = (SDL_Rect){0, ROAD_Y_START + offset, length, laneWidth};
+                    bar = (SDL_Rect){ROAD_X_START - queueLength, band.y + barWidth, queueLength, barWidth};
+                    break;
+                case 1: // B: top approach, heading down
+                    band = (SDL_Rect){ROAD_X_START + offset, 0, laneWidth, length};
+                    bar = (SDL_Rect){band.x + barWidth, ROAD_Y_START - queueLength, barWidth, queueLength};
+                    break;
+                case 2: // C: right approach, heading left
+                    band = (SDL_Rect){ROAD_X_START + ROAD_WIDTH, ROAD_Y_START + offset, length, laneWidth};
+                    bar = (SDL_Rect){band.x, band.y + barWidth, queueLength, barWidth};
+                    break;
+                default: // D: bottom approach, heading up
+                    band = (SDL_Rect){ROAD_X_START + offset, ROAD_Y_START + ROAD_HEIGHT, laneWidth, length};
+                    bar = (SDL_Rect){band.x + barWidth, band.y, barWidth, queueLength};
+                    break;
+            }
+
+            SDL_SetRenderDrawColor(renderer, (Uint8)(255 * density), (Uint8)(255 * (1.0f - density)), 40, 255);
+            fillWorldRect(renderer, band);
+            if (queueLength > 0) {
+                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+                fillWorldRect(renderer, bar);
+            }
         }
     }
 }
@@ -165,8 +431,113 @@ bool isNearLight(Vehicle *v) {
             v->y > ROAD_Y_START - 100 && v->y < ROAD_Y_START + ROAD_WIDTH + 100);
 }
 
+// Advance the simulation by exactly one fixed step of SIMULATION_STEP_MS.
+void stepSimulation(PriorityQueue *pq) {
+    simulationTime += SIMULATION_STEP_MS;
+
+    // --- Traffic Light Control: Determine which road gets the green light ---
+    if (simulationTime - currentGreenStartTime >= currentGreenDuration) {
+        // First, update the priority queue for any high-priority lane.
+        handlePriorityRoads(pq, vehicles);
+        bool priorityFound = false;
+        // Check if any lane in the priority queue has the high priority value.
+        for (int i = 0; i < pq->size; i++) {
+            if (pq->data[i].priority == 10) {
+                currentGreenRoad = pq->data[i].road;
+                priorityFound = true;
+                break;
+            }
+        }
+        // If no priority lane is found, use round-robin rotation.
+        if (!priorityFound) {
+            currentRoadIndex = (currentRoadIndex + 1) % 4;
+            currentGreenRoad = roads[currentRoadIndex];
+        }
+        // Determine how many vehicles are waiting on the current green road.
+        int vehiclesToServe = countWaitingVehicles(vehicles, currentGreenRoad);
+        if (vehiclesToServe <= 0)
+            vehiclesToServe = 2;  // minimum duration if no vehicles are waiting
+        currentGreenDuration = vehiclesToServe * TIME_PER_VEHICLE;
+        currentGreenStartTime = simulationTime;
+        if (logEvents)
+            printf("Green light for Road %c for %d ms (waiting vehicles: %d)\n",
+                   currentGreenRoad, currentGreenDuration, vehiclesToServe);
+    }
+    
+    // --- Traffic Generation and Queue Management ---
+    generateVehicle(pq, vehicles, &lastVehicleId);
+    handlePriorityRoads(pq, vehicles);
+    
+    // --- Update Vehicle Positions ---
+    // updateVehicles now uses our updated isLightRedForVehicle logic.
+    updateVehicles(vehicles);
+    
+    // --- Vehicle Redirection at Intersection ---
+    for (int i = 0; i < MAX_VEHICLES; i++) {
+        if (vehicles[i].id != -1) {
+            // Check if the vehicle is within the intersection bounds.
+            bool inIntersection = (
+                vehicles[i].x >= ROAD_X_START && 
+                vehicles[i].x <= ROAD_X_START + ROAD_WIDTH &&
+                vehicles[i].y >= ROAD_Y_START && 
+                vehicles[i].y <= ROAD_Y_START + ROAD_WIDTH
+            );
+            if (inIntersection && shouldRedirect()) {
+                redirectVehicle(&vehicles[i]);
+            }
+        }
+    }
+}
+
+void renderScene(SDL_Renderer *renderer) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    renderLane(renderer);
+    renderZebraCrossing(renderer);
+    if (camera.zoom < LOD_ZOOM_THRESHOLD) {
+        renderLaneDensity(renderer);
+    } else {
+        buildVehicleGrid();
+        renderVehicles(renderer);
+    }
+    renderTrafficLights(renderer);
+    SDL_RenderPresent(renderer);
+}
+
+// Keys 1-4 select the time scale, space pauses and resumes.
+// Returns true if the event was consumed.
+bool handleTimeScaleEvent(SDL_Event *e) {
+    if (e->type != SDL_KEYDOWN)
+        return false;
+    int newIndex;
+    switch (e->key.keysym.sym) {
+        case SDLK_1: newIndex = 1; break;
+        case SDLK_2: newIndex = 2; break;
+        case SDLK_3: newIndex = 3; break;
+        case SDLK_4: newIndex = 4; break;
+        case SDLK_SPACE:
+            if (timeScaleIndex == 0) {
+                newIndex = pausedTimeScaleIndex;
+            } else {
+                pausedTimeScaleIndex = timeScaleIndex;
+                newIndex = 0;
+            }
+            break;
+        default:
+            return false;
+    }
+    timeScaleIndex = newIndex;
+    logEvents = timeScales[timeScaleIndex] <= 1.0f;
+    if (timeScaleIndex == 0)
+        printf("Simulation paused\n");
+    else
+        printf("Time scale: %gx\n", timeScales[timeScaleIndex]);
+    return true;
+}
+
 int main() {
     srand(time(NULL));
+    simulationEpoch = time(NULL);
     if (SDL_Init(SDL_INIT_VIDEO) < 0 || IMG_Init(IMG_INIT_PNG) != IMG_INIT_PNG) {
         printf("Failed to initialize SDL: %s\n", SDL_GetError());
         return -1;
@@ -226,85 +597,62 @@ int main() {
 
     // Initialize our green-light timer and road rotation
     currentGreenRoad = roads[currentRoadIndex];
-    currentGreenStartTime = SDL_GetTicks();
+    currentGreenStartTime = simulationTime;
     currentGreenDuration = 4000; // initial default
 
     bool quit = false;
     SDL_Event e;
     Uint32 frameStart, frameTime;
 
+    // Simulated time owed to the simulation, in ms, and the real-time clock
+    Uint64 perfFrequency = SDL_GetPerformanceFrequency();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    Uint64 lastRender = lastCounter;
+    Uint64 lastRenderCost = 0;
+    double simulationLag = 0.0;
+
     while (!quit) {
         frameStart = SDL_GetTicks();
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT)
                 quit = true;
+            else if (!handleTimeScaleEvent(&e))
+                handleCameraEvent(&e);
         }
-        
-        Uint32 currentTime = SDL_GetTicks();
-        
-        // --- Traffic Light Control: Determine which road gets the green light ---
-        if (currentTime - currentGreenStartTime >= currentGreenDuration) {
-            // First, update the priority queue for any high-priority lane.
-            handlePriorityRoads(&pq, vehicles);
-            bool priorityFound = false;
-            // Check if any lane in the priority queue has the high priority value.
-            for (int i = 0; i < pq.size; i++) {
-                if (pq.data[i].priority == 10) {
-                    currentGreenRoad = pq.data[i].road;
-                    priorityFound = true;
-                    break;
-                }
-            }
-            // If no priority lane is found, use round-robin rotation.
-            if (!priorityFound) {
-                currentRoadIndex = (currentRoadIndex + 1) % 4;
-                currentGreenRoad = roads[currentRoadIndex];
-            }
-            // Determine how many vehicles are waiting on the current green road.
-            int vehiclesToServe = countWaitingVehicles(vehicles, currentGreenRoad);
-            if (vehiclesToServe <= 0)
-                vehiclesToServe = 2;  // minimum duration if no vehicles are waiting
-            currentGreenDuration = vehiclesToServe * TIME_PER_VEHICLE;
-            currentGreenStartTime = currentTime;
-            printf("Green light for Road %c for %d ms (waiting vehicles: %d)\n",
-                   currentGreenRoad, currentGreenDuration, vehiclesToServe);
+
+        // --- Simulation: advance in fixed steps of simulated time ---
+        Uint64 now = SDL_GetPerformanceCounter();
+        double elapsedMs = (double)(now - lastCounter) * 1000.0 / perfFrequency;
+        lastCounter = now;
+        simulationLag += elapsedMs * timeScales[timeScaleIndex];
+        // Never owe more than MAX_LAG_MS of real time. The rest is dropped,
+        // so an overloaded machine runs slower than requested rather than spiralling.
+        double maxLag = MAX_LAG_MS * timeScales[timeScaleIndex] + SIMULATION_STEP_MS;
+        if (simulationLag > maxLag)
+            simulationLag = maxLag;
+
+        Uint64 budgetEnd = now + perfFrequency * STEP_BUDGET_MS / 1000;
+        while (simulationLag >= SIMULATION_STEP_MS) {
+            stepSimulation(&pq);
+            simulationLag -= SIMULATION_STEP_MS;
+            if (SDL_GetPerformanceCounter() >= budgetEnd)
+                break;
         }
-        
-        // --- Traffic Generation and Queue Management ---
-        generateVehicle(&pq, vehicles, &lastVehicleId);
-        handlePriorityRoads(&pq, vehicles);
-        
-        // --- Update Vehicle Positions ---
-        // updateVehicles now uses our updated isLightRedForVehicle logic.
-        updateVehicles(vehicles);
-        
-        // --- Vehicle Redirection at Intersection ---
-        for (int i = 0; i < MAX_VEHICLES; i++) {
-            if (vehicles[i].id != -1) {
-                // Check if the vehicle is within the intersection bounds.
-                bool inIntersection = (
-                    vehicles[i].x >= ROAD_X_START && 
-                    vehicles[i].x <= ROAD_X_START + ROAD_WIDTH &&
-                    vehicles[i].y >= ROAD_Y_START && 
-                    vehicles[i].y <= ROAD_Y_START + ROAD_WIDTH
-                );
-                if (inIntersection && shouldRedirect()) {
-                    redirectVehicle(&vehicles[i]);
-                }
-            }
+        bool behind = simulationLag >= SIMULATION_STEP_MS;
+
+        // --- Rendering: the step budget leaves the rest of the frame for drawing,
+        // so present every frame. Only when drawing itself overruns that share
+        // while behind are frames skipped, and never for long.
+        bool renderTooSlow = lastRenderCost * 1000 > perfFrequency * (FRAME_DELAY - STEP_BUDGET_MS);
+        if (!behind || !renderTooSlow || (now - lastRender) * 1000 >= perfFrequency * MAX_FRAME_SKIP_MS) {
+            Uint64 renderStart = SDL_GetPerformanceCounter();
+            renderScene(renderer);
+            lastRenderCost = SDL_GetPerformanceCounter() - renderStart;
+            lastRender = now;
         }
-        
-        // --- Rendering ---
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        renderLane(renderer);
-        renderZebraCrossing(renderer);
-        renderVehicles(renderer);
-        renderTrafficLights(renderer);
-        SDL_RenderPresent(renderer);
-        
+
         frameTime = SDL_GetTicks() - frameStart;
-        if (frameTime < FRAME_DELAY)
+        if (!behind && frameTime < FRAME_DELAY)
             SDL_Delay(FRAME_DELAY - frameTime);
     }
 
@@ -8,7 +8,7 @@
 #define VEHICLE_SPAWN_INTERVAL 2000 // 2 seconds
 #define MIN_VEHICLE_SPACING 100     // Minimum spacing between vehicles
 
-extern Uint32 lastSpawnTime;
+extern Uint64 lastSpawnTime;
 
 // Helper function to calculate distance between two vehicles
 float distanceBetweenVehicles(Vehicle *v1, Vehicle *v2) {
@@ -16,7 +16,7 @@ float distanceBetweenVehicles(Vehicle *v1, Vehicle *v2) {
 }
 
 void generateVehicle(PriorityQueue *pq, Vehicle vehicles[], int *lastVehicleId) {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint64 currentTime = simulationTime;
     if (currentTime - lastSpawnTime < VEHICLE_SPAWN_INTERVAL)
         return;
 
@@ -115,8 +115,8 @@ void generateVehicle(PriorityQueue *pq, Vehicle vehicles[], int *lastVehicleId)
     }
     FILE *fp = fopen(filename, "a");
     if (fp) {
-        // Format current time as HH:MM:SS
-        time_t now = time(NULL);
+        // Format the simulated time as HH:MM:SS
+        time_t now = simulationEpoch + (time_t)(simulationTime / 1000);
         struct tm *tm_info = localtime(&now);
         char timeStr[9];
         strftime(timeStr, 9, "%H:%M:%S", tm_info);
@@ -127,8 +127,9 @@ void generateVehicle(PriorityQueue *pq, Vehicle vehicles[], int *lastVehicleId)
         fclose(fp);
     }
 
-    printf("Generated vehicle: ID=%d, Road=%c, Lane=%d, Direction=%s, X=%d, Y=%d\n", 
-           v->id, v->road, v->lane, (willTurnLeft ? "left" : "straight"), (int)v->x, (int)v->y);
+    if (logEvents)
+        printf("Generated vehicle: ID=%d, Road=%c, Lane=%d, Direction=%s, X=%d, Y=%d\n", 
+               v->id, v->road, v->lane, (willTurnLeft ? "left" : "straight"), (int)v->x, (int)v->y);
     lastSpawnTime = currentTime;
 }
 
@@ -157,6 +158,7 @@ void redirectVehicle(Vehicle *v) {
         v->lane = newLane;
     }
     
-    printf("Redirected vehicle at intersection: ID=%d, Road=%c, New Lane=%d, X=%d, Y=%d\n", 
-           v->id, v->road, v->lane, (int)v->x, (int)v->y);
+    if (logEvents)
+        printf("Redirected vehicle at intersection: ID=%d, Road=%c, New Lane=%d, X=%d, Y=%d\n", 
+               v->id, v->road, v->lane, (int)v->x, (int)v->y);
 }